@@ -7,13 +7,13 @@ bool AbortableBarrier::wait_at_barrier() {
 	if (--waiting_for_workers == 0) {
 		generation++; // overflows are OK
 		waiting_for_workers = workers;
-		cond.notify_all();
+		barrier_cond.notify_all();
 		return true;
 	}
 
 	size_t current_generation = generation;
 	while (true) {
-		cond.wait(lock);
+		barrier_cond.wait(lock);
 		if (aborted) throw aborted_error();
 		if (generation != current_generation) return false;
 	}
@@ -29,5 +29,6 @@ bool AbortableBarrier::abort() {
 	if (aborted) return false;
 	aborted = true;
 	cond.notify_all();
+	barrier_cond.notify_all();
 	return true;
 }
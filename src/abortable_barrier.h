@@ -18,7 +18,8 @@ struct AbortableBarrier {
 	bool abort();
 
 	std::mutex mutex;
-	std::condition_variable cond;
+	std::condition_variable cond; // for derived classes to signal their own state changes under our mutex
+	std::condition_variable barrier_cond; // separate so those signals don't wake workers parked at a barrier (and vice versa)
 	size_t workers;
 	size_t waiting_for_workers;
 	size_t generation;
@@ -88,6 +88,18 @@ inline void send_command(Packer<OutputStream> &packer, verb_t verb, const Values
 	}
 }
 
+// as send_command, but leaves the bytes in the stream's write buffer instead of pushing them to the
+// descriptor straight away, so that consecutive small commands coalesce into one write rather than
+// each paying the syscall and packetization overhead.  callers must ensure the stream gets flushed
+// before they block waiting for the response.
+template <typename OutputStream, typename... Values>
+inline void send_command_without_flush(Packer<OutputStream> &packer, verb_t verb, const Values &...args) {
+	send_command_begin(packer, verb, args...);
+	if (sizeof...(Values) > 0) { // in which case send_command_begin has already sent the empty array to indicate no more arguments
+		pack_array_length(packer, 0); // each command is terminated by an array of length 0
+	}
+}
+
 namespace Commands {
 	const verb_t ROWS = 2;
 	const verb_t HASH = 7;
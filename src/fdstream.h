@@ -2,7 +2,9 @@
 #define FDSTREAM_H
 
 #include <unistd.h>
+#include <sys/uio.h>
 #include <stdexcept>
+#include <vector>
 
 struct stream_error: public std::runtime_error {
 	stream_error(const std::string &error): runtime_error(error) {}
@@ -13,7 +15,11 @@ struct stream_closed_error: public stream_error {
 };
 
 struct FDReadStream {
-	FDReadStream(int fd): fd(fd), buf_pos(0), buf_avail(0) {}
+	// a large readahead buffer means that streams of small fields get decoded out of memory with only
+	// an occasional read syscall, rather than paying one syscall per buffer's worth of small reads
+	static const size_t READ_BUFFER_SIZE = 256*1024;
+
+	FDReadStream(int fd): fd(fd), buf(READ_BUFFER_SIZE), buf_pos(0), buf_avail(0) {}
 
 	~FDReadStream() {
 		close();
@@ -29,12 +35,18 @@ struct FDReadStream {
 	// reads the given number of bytes from the data stream without unpacking or endian conversion
 	inline void read(uint8_t *dest, size_t bytes) {
 		while (bytes > buf_avail) {
-			memcpy(dest, buf + buf_pos, buf_avail);
+			memcpy(dest, buf.data() + buf_pos, buf_avail);
 			dest  += buf_avail;
 			bytes -= buf_avail;
+			buf_pos = buf_avail = 0;
+			if (bytes >= buf.size()) {
+				// large payloads bypass the buffer entirely so they don't get copied twice
+				read_buf(dest, bytes);
+				return;
+			}
 			populate_buf();
 		}
-		memcpy(dest, buf + buf_pos, bytes);
+		memcpy(dest, buf.data() + buf_pos, bytes);
 		buf_pos   += bytes;
 		buf_avail -= bytes;
 	}
@@ -56,7 +68,7 @@ protected:
 		ssize_t bytes_read;
 		buf_pos = 0;
 		while (true) {
-			bytes_read = ::read(fd, buf, sizeof(buf));
+			bytes_read = ::read(fd, buf.data(), buf.size());
 			if (bytes_read == 0) {
 				buf_avail = 0;
 				throw stream_closed_error();
@@ -71,9 +83,25 @@ protected:
 		}
 	}
 
+	// reads exactly the given number of bytes straight into the caller's storage
+	void read_buf(uint8_t *dest, size_t bytes) {
+		while (bytes > 0) {
+			ssize_t bytes_read = ::read(fd, dest, bytes);
+			if (bytes_read == 0) {
+				throw stream_closed_error();
+			}
+			if (bytes_read < 0) {
+				if (errno == EINTR) continue;
+				throw stream_error("Couldn't read from descriptor: " + string(strerror(errno)));
+			}
+			dest  += bytes_read;
+			bytes -= bytes_read;
+		}
+	}
+
 	int fd;
+	std::vector<uint8_t> buf;
 	size_t buf_pos, buf_avail;
-	uint8_t buf[16384];
 };
 
 struct FDWriteStream {
@@ -93,8 +121,7 @@ struct FDWriteStream {
 	// writes the given number of bytes as-is to the data stream, possibly using a buffer; call flush() to force that to the underlying descriptor
 	inline void write(const uint8_t *src, size_t bytes) {
 		if (bytes > sizeof(buf)) { // this both protects against integer overflows and avoids unnecessary copying into our buffer for large objects
-			flush();
-			write_buf(src, bytes);
+			write_both(src, bytes);
 
 		} else if (buf_used + bytes > sizeof(buf)) {
 			flush();
@@ -127,9 +154,32 @@ protected:
 		}
 	}
 
+	// drains whatever is in the buffer plus the given large payload in a single writev syscall,
+	// rather than paying one syscall to flush the buffer and another to write the payload
+	void write_both(const uint8_t *src, size_t bytes) {
+		struct iovec iov[2] = { { buf, buf_used }, { (void *)src, bytes } };
+		size_t index = (buf_used ? 0 : 1);
+		while (index < 2) {
+			ssize_t bytes_written = ::writev(fd, iov + index, 2 - index);
+			if (bytes_written <= 0) {
+				if (errno == EINTR) continue;
+				throw stream_error("Couldn't write to descriptor: " + string(strerror(errno)));
+			}
+			while (index < 2 && (size_t)bytes_written >= iov[index].iov_len) {
+				bytes_written -= iov[index].iov_len;
+				index++;
+			}
+			if (index < 2) {
+				iov[index].iov_base = (uint8_t *)iov[index].iov_base + bytes_written;
+				iov[index].iov_len -= bytes_written;
+			}
+		}
+		buf_used = 0;
+	}
+
 	int fd;
 	size_t buf_used;
-	uint8_t buf[16384];
+	uint8_t buf[65536]; // sized so that a run of small commands coalesces into one write, amortizing the syscall overhead and letting TCP fill full segments
 };
 
 #endif
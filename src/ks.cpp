@@ -48,6 +48,14 @@ bool greet_remote_server(Options &options, vector<const char*>::const_iterator c
 	return true;
 }
 
+void stop_ssh_master(const string &ssh_binary, const string &control_path, const string &via) {
+	// shut down the master connection; we don't much care whether this succeeds, as ControlPersist
+	// means the master will exit on its own shortly after its last client is gone anyway - this just
+	// makes it (and its control socket) go away promptly rather than after the persist timeout
+	const char *exit_args[] = { ssh_binary.c_str(), "-q", "-S", control_path.c_str(), "-O", "exit", via.c_str(), nullptr };
+	Process::wait_for_and_check(Process::fork_and_exec(ssh_binary, exit_args));
+}
+
 int main(int argc, char *argv[]) {
 	try
 	{
@@ -67,13 +75,63 @@ int main(int argc, char *argv[]) {
 		string  ssh_binary("/usr/bin/ssh");
 
 		if (options.cipher.empty()) options.cipher = DEFAULT_CIPHER;
+		if (options.macs.empty()) options.macs = DEFAULT_MACS;
+		string mac_option("MACs=" + options.macs);
+		string control_path("/tmp/ks." + to_string(getpid()) + ".sock");
+
+		if (!options.via.empty() && options.ssh_multiplex) {
+			// establish one master connection up front that the workers will open channels over,
+			// instead of each doing its own handshake.  -f makes ssh background itself only once
+			// authentication has completed, so when this returns the master is ready to use.
+			// ControlPersist makes the master exit (and remove its control socket) on its own once
+			// it has had no clients for a while, so it can't be left running forever if we bail out
+			// on an error path without reaching the explicit teardown below.
+			vector<const char*> master_args;
+			master_args.push_back(ssh_binary.c_str());
+			master_args.push_back("-f");
+			master_args.push_back("-N");
+			master_args.push_back("-M");
+			master_args.push_back("-o");
+			master_args.push_back("ControlPersist=60");
+			master_args.push_back("-S");
+			master_args.push_back(control_path.c_str());
+			master_args.push_back("-c");
+			master_args.push_back(options.cipher.c_str());
+			master_args.push_back("-o");
+			master_args.push_back(mac_option.c_str());
+			if (!options.via_port.empty()) {
+				master_args.push_back("-p");
+				master_args.push_back(options.via_port.c_str());
+			}
+			master_args.push_back(options.via.c_str());
+			master_args.push_back(nullptr);
+
+			if (!Process::wait_for_and_check(Process::fork_and_exec(ssh_binary, master_args.data()))) {
+				cerr << "Couldn't establish the SSH master connection to " << options.via << "." << endl;
+				return 1;
+			}
+		}
 
 		vector<const char*> from_args;
 		if (!options.via.empty()) {
 			from_args.push_back(ssh_binary.c_str());
-			from_args.push_back("-C");
+			// compression is worthwhile on slow WAN links, but on fast links the compression CPU
+			// becomes the bottleneck before the network does, so we only force it on request;
+			// 'auto' defers to the user's ssh configuration (whose default is no compression)
+			if (options.compress == "on") {
+				from_args.push_back("-C");
+			} else if (options.compress == "off") {
+				from_args.push_back("-o");
+				from_args.push_back("Compression=no");
+			}
 			from_args.push_back("-c");
 			from_args.push_back(options.cipher.c_str());
+			from_args.push_back("-o");
+			from_args.push_back(mac_option.c_str());
+			if (options.ssh_multiplex) {
+				from_args.push_back("-S");
+				from_args.push_back(control_path.c_str());
+			}
 			if (!options.via_port.empty()) {
 				from_args.push_back("-p");
 				from_args.push_back(options.via_port.c_str());
@@ -113,6 +171,7 @@ int main(int argc, char *argv[]) {
 
 		if (!options.via.empty()) {
 			if (!greet_remote_server(options, from_args.begin(), from_args.begin() + connection_args, from_binary)) {
+				if (options.ssh_multiplex) stop_ssh_master(ssh_binary, control_path, options.via);
 				return 1;
 			}
 		}
@@ -161,6 +220,10 @@ int main(int argc, char *argv[]) {
 			success &= Process::wait_for_and_check(pid);
 		}
 
+		if (!options.via.empty() && options.ssh_multiplex) {
+			stop_ssh_master(ssh_binary, control_path, options.via);
+		}
+
 		if (success) {
 			cout << "Finished Kitchen Syncing." << endl;
 			time_t t = time(NULL);
@@ -11,7 +11,7 @@
 #include "version.h"
 
 struct Options {
-	inline Options(): workers(1), verbose(0), progress(false), snapshot(true), alter(false), structure_only(false),
+	inline Options(): compress("auto"), ssh_multiplex(false), workers(1), verbose(0), progress(false), snapshot(true), alter(false), structure_only(false),
     commit_level(CommitLevel::often), hash_algorithm(HashAlgorithm::auto_select) {}
 
 	void help() {
@@ -34,6 +34,23 @@ struct Options {
 			"  --cipher                   Specify the cipher when using 'via' option.\n"
 			"                             Defaults to " << DEFAULT_CIPHER << ".\n"
 			"\n"
+			"  --macs                     Specify the MACs when using the 'via' option.\n"
+			"                             Defaults to " << DEFAULT_MACS << ".\n"
+			"\n"
+			"  --compress arg             Whether to compress the SSH transport when using the\n"
+			"                             'via' option.  May be 'on', 'off', or 'auto' (the\n"
+			"                             default, which leaves it to your ssh configuration).\n"
+			"                             Compression helps on slow WAN links but is usually a\n"
+			"                             net loss on fast links, where the compression CPU\n"
+			"                             becomes the bottleneck before the network does.\n"
+			"\n"
+			"  --ssh-multiplex            Run the 'via' SSH connections over a single multiplexed\n"
+			"                             master connection.  This makes startup faster when\n"
+			"                             using many workers as only one SSH handshake is\n"
+			"                             needed, but all workers then share one TCP connection,\n"
+			"                             which can limit total throughput on fast, high-latency\n"
+			"                             links.\n"
+			"\n"
 			"  --workers num              The number of concurrent workers to use at each end.\n"
 			"                             Defaults to 1.\n"
 			"\n"
@@ -123,6 +140,9 @@ struct Options {
 					{ "to",							required_argument,	NULL,	't' },
 					{ "via",						required_argument,	NULL,	'v' },
 					{ "cipher",						required_argument,	NULL,	'C' },
+					{ "macs",						required_argument,	NULL,	'm' },
+					{ "compress",					required_argument,	NULL,	'z' },
+					{ "ssh-multiplex",				no_argument,		NULL,	'M' },
 					{ "from-path",					required_argument,	NULL,	'P' },
 					{ "workers",					required_argument,	NULL,	'w' },
 					{ "ignore",						required_argument,	NULL,	'i' },
@@ -209,6 +229,21 @@ struct Options {
 						cipher = optarg;
 						break;
 
+					case 'm':
+						macs = optarg;
+						break;
+
+					case 'z':
+						if (strcmp(optarg, "auto") && strcmp(optarg, "on") && strcmp(optarg, "off")) {
+							throw invalid_argument("Unknown compression setting: " + string(optarg));
+						}
+						compress = optarg;
+						break;
+
+					case 'M':
+						ssh_multiplex = true;
+						break;
+
 					case 'c':
 						if (!strcmp(optarg, "never")) {
 							commit_level = CommitLevel::never;
@@ -277,6 +312,9 @@ struct Options {
 	string via;
 	string via_port;
 	string cipher;
+	string macs;
+	string compress;
+	bool ssh_multiplex;
 	string from_path;
 	string filters;
 	string set_from_variables;
@@ -3,11 +3,14 @@
 #include <stdexcept>
 #include <cerrno>
 #include <cstring>
+#include <spawn.h>
 #include <unistd.h>
 #include <sys/wait.h>
 
 #include "unidirectional_pipe.h"
 
+extern char **environ;
+
 string Process::binary_path_only(const string &argv0, const string &this_program_name) {
 	if (argv0.length() > this_program_name.length() &&
 		argv0[argv0.length() - this_program_name.length() - 1] == '/' &&
@@ -25,53 +28,37 @@ string describe_error(const string &binary, int err) {
 }
 
 pid_t Process::fork_and_exec(const string &binary, const char *args[]) {
-	pid_t child = fork();
-
-	if (child < 0) {
-		// hit the process limit
-		throw runtime_error("Couldn't fork to start binary: " + string(strerror(errno)));
-
-	} else if (child == 0) {
-		// we are the child; run the binary
-		if (execvp(binary.c_str(), (char * const *)args) < 0) {
-			throw runtime_error(describe_error(binary, errno));
-		}
-		throw logic_error("execv returned");
+	// posix_spawn avoids duplicating our address space the way fork does, and unlike a failed exec
+	// in a forked child, any error comes back to us directly as a return value
+	pid_t child;
+	int err = posix_spawnp(&child, binary.c_str(), nullptr, nullptr, (char * const *)args, environ);
 
-	} else {
-		return child;
+	if (err) {
+		throw runtime_error(describe_error(binary, err));
 	}
+
+	return child;
 }
 
 pid_t Process::fork_and_exec(const string &binary, const char *args[], UnidirectionalPipe &stdin_pipe, UnidirectionalPipe &stdout_pipe) {
-	pid_t child = fork();
-
-	if (child < 0) {
-		// hit the process limit
-		throw runtime_error("Couldn't fork to start binary: " + string(strerror(errno)));
-
-	} else if (child == 0) {
-		// we are the child; close the ends of the pipe that we won't use (as otherwise we'd not see the pipes close when the other end is done)
-		stdin_pipe.close_write();
-		stdout_pipe.close_read();
-
-		// attach our stdin
-		stdin_pipe.dup_read_to(STDIN_FILENO);
-		stdin_pipe.close_read();
-
-		// attach our stdout
-		stdout_pipe.dup_write_to(STDOUT_FILENO);
-		stdout_pipe.close_write();
-
-		// run the binary
-		if (execvp(binary.c_str(), (char * const *)args) < 0) {
-			throw runtime_error(describe_error(binary, errno));
-		}
-		throw logic_error("execv returned");
-
-	} else {
-		return child;
+	// attach the child's stdin and stdout to the pipes.  dup2 clears the close-on-exec flag that
+	// pipe descriptors are created with, so these two copies are all the child keeps - the original
+	// descriptors and the ends the child shouldn't have close automatically when it execs, which is
+	// what lets it see the pipes close when the other end is done.
+	posix_spawn_file_actions_t file_actions;
+	posix_spawn_file_actions_init(&file_actions);
+	posix_spawn_file_actions_adddup2(&file_actions, stdin_pipe.read_fileno(), STDIN_FILENO);
+	posix_spawn_file_actions_adddup2(&file_actions, stdout_pipe.write_fileno(), STDOUT_FILENO);
+
+	pid_t child;
+	int err = posix_spawnp(&child, binary.c_str(), &file_actions, nullptr, (char * const *)args, environ);
+	posix_spawn_file_actions_destroy(&file_actions);
+
+	if (err) {
+		throw runtime_error(describe_error(binary, err));
 	}
+
+	return child;
 }
 
 bool Process::wait_for_and_check(pid_t child) {
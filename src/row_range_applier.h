@@ -52,9 +52,12 @@ struct RowRangeApplier {
 		return primary_key;
 	}
 
-	void received_source_row(const PackedRow &row) {
+	void received_source_row(PackedRow &row) {
 		curr_key = primary_key_of(row);
-		source_rows[curr_key] = row;
+		for (const PackedValue &value : row) {
+			approx_buffered_bytes += value.encoded_size();
+		}
+		source_rows[curr_key] = std::move(row); // our caller reuses the row object, but unpacking the next row clears it first, so moving is safe and saves copying each value's buffer
 
 		// if the other end is sending a large set of data (for example, the entire remainder of the
 		// table), we need to periodically apply the data received so far rather than buffering up
@@ -62,9 +65,6 @@ struct RowRangeApplier {
 		// mostly avoided this particular problem, but we still had trouble in the case where the
 		// source dataset had deleted a large range that was still present on the local end; this
 		// way around requires fewer special cases.
-		for (const PackedValue &value : row) {
-			approx_buffered_bytes += value.encoded_size();
-		}
 		if (approx_buffered_bytes > MAX_BYTES_TO_BUFFER) {
 			check_rows_to_curr_key();
 			insert_remaining_rows();
@@ -139,7 +139,7 @@ struct RowRangeApplier {
 
 		if (replacer.insert_sql.curr.size() > MAX_SENSIBLE_INSERT_STATEMENT_SIZE) return true;
 
-		for (auto unique_key_clearer : replacer.unique_key_clearers) {
+		for (const UniqueKeyClearer<DatabaseClient> &unique_key_clearer : replacer.unique_key_clearers) {
 			if (unique_key_clearer.delete_sql.curr.size() > MAX_SENSIBLE_DELETE_STATEMENT_SIZE) return true;
 		}
 
@@ -2,9 +2,10 @@
 #define SYNC_QUEUE_H
 
 #include <queue>
-#include <list>
+#include <vector>
 #include <set>
 #include <memory>
+#include <chrono>
 
 #include "abortable_barrier.h"
 #include "schema.h"
@@ -32,7 +33,7 @@ struct lower_priority {
 };
 
 struct TableJob {
-	TableJob(const Table &table): table(table), table_id(table.id_from_name()), subdividable(primary_key_subdividable(table)), notify_when_work_could_be_shared(false), time_started(0), time_finished(0), hash_commands(0), hash_commands_completed(0), rows_commands(0) {}
+	TableJob(const Table &table): table(table), table_id(table.id_from_name()), subdividable(primary_key_subdividable(table)), notify_when_work_could_be_shared(false), hash_commands(0), hash_commands_completed(0), rows_commands(0) {}
 
 	inline bool have_work_to_share() { return (!ranges_to_check.empty()); }
 
@@ -47,8 +48,11 @@ struct TableJob {
 	priority_queue<KeyRangeToCheck, deque<KeyRangeToCheck>, lower_priority> ranges_to_check;
 	bool notify_when_work_could_be_shared;
 
-	time_t time_started;
-	time_t time_finished;
+	// steady_clock rather than time() so elapsed times have sub-second resolution (short tables used
+	// to round down to 0s) and can't be thrown off by wall clock adjustments.  the default-constructed
+	// (epoch) value means the table hasn't been started yet.
+	chrono::steady_clock::time_point time_started;
+	chrono::steady_clock::time_point time_finished;
 
 	size_t hash_commands;
 	size_t hash_commands_completed;
@@ -57,11 +61,12 @@ struct TableJob {
 
 template <typename DatabaseClient>
 struct SyncQueue: public AbortableBarrier {
-	SyncQueue(size_t workers): AbortableBarrier(workers), sharing_work(false) {}
+	SyncQueue(size_t workers): AbortableBarrier(workers), next_table_to_process(0), sharing_work(false) {}
 
 	void enqueue_tables_to_process(const Tables &tables) {
 		unique_lock<std::mutex> lock(mutex);
 
+		tables_to_process.reserve(tables.size());
 		for (const Table &from_table : tables) {
 			tables_to_process.push_back(make_shared<TableJob>(from_table));
 		}
@@ -72,13 +77,12 @@ struct SyncQueue: public AbortableBarrier {
 
 		if (aborted) throw aborted_error();
 
-		if (tables_to_process.empty()) {
+		if (next_table_to_process >= tables_to_process.size()) {
 			if (!sharing_work) start_sharing_work();
 			return borrow_work(lock);
 		}
 
-		shared_ptr<TableJob> table_job = tables_to_process.front();
-		tables_to_process.pop_front();
+		shared_ptr<TableJob> table_job = tables_to_process[next_table_to_process++];
 		tables_being_processed.insert(table_job);
 
 		return table_job;
@@ -121,12 +125,12 @@ struct SyncQueue: public AbortableBarrier {
 
 private:
 	inline bool finished() {
-		return (tables_to_process.empty() && tables_being_processed.empty());
+		return (next_table_to_process >= tables_to_process.size() && tables_being_processed.empty());
 	}
 
 	void start_sharing_work() {
 		sharing_work = true;
-		for (shared_ptr<TableJob> table_job : tables_to_process)      start_sharing_work_in(table_job);
+		for (size_t table = next_table_to_process; table < tables_to_process.size(); table++) start_sharing_work_in(tables_to_process[table]);
 		for (shared_ptr<TableJob> table_job : tables_being_processed) start_sharing_work_in(table_job);
 	}
 
@@ -160,7 +164,12 @@ private:
 	}
 
 	bool sharing_work;
-	list<shared_ptr<TableJob>> tables_to_process;
+	// all the tables are queued by the leader before any worker claims one (see enqueue_tables and
+	// its barrier), so rather than popping from a list of separately-allocated nodes we lay the jobs
+	// out in one contiguous vector and advance a cursor over it.  claiming a table still happens
+	// under the queue mutex, which we need anyway to track tables_being_processed for work sharing.
+	vector<shared_ptr<TableJob>> tables_to_process;
+	size_t next_table_to_process;
 	set<shared_ptr<TableJob>> tables_being_processed;
 	set<shared_ptr<TableJob>> tables_with_work_to_share;
 };
@@ -45,12 +45,22 @@ struct SyncToWorker {
 			hash_algorithm(hash_algorithm),
 			target_minimum_block_size(target_minimum_block_size),
 			target_maximum_block_size(target_maximum_block_size),
-			structure_only(structure_only),
-			worker_thread(std::ref(*this)) {
+			structure_only(structure_only) {
 	}
 
 	~SyncToWorker() {
-		worker_thread.join();
+		join();
+	}
+
+	// starting the thread is a separate step rather than done in the constructor so that the object is
+	// fully constructed before the thread can touch it, and so a failure constructing a later worker
+	// can't leave us with running threads to clean up
+	void start() {
+		worker_thread = std::thread(std::ref(*this));
+	}
+
+	void join() {
+		if (worker_thread.joinable()) worker_thread.join();
 	}
 
 	void operator()() {
@@ -91,11 +101,17 @@ struct SyncToWorker {
 
 	void sync() {
 		try {
-			enqueue_tables();
-
+			// the write transaction doesn't depend on anything the other workers do, so we set it up
+			// before waiting for them at the enqueue_tables barrier - that way each worker's round-trips
+			// to the database overlap with the others' instead of running one after another once the
+			// last worker arrives.  it can't be started any earlier than this, though: with --alter,
+			// compare_schema runs DDL, which has to stay outside the write transaction (on mysql it
+			// would implicitly commit it).
 			client.start_write_transaction();
 			client.disable_referential_integrity(leader);
 
+			enqueue_tables();
+
 			SyncToAlgorithm<SyncToWorker<DatabaseClient>, DatabaseClient> sync_to_protocol(*this);
 			sync_to_protocol.sync_tables();
 
@@ -309,26 +325,26 @@ struct SyncToWorker {
 	}
 
 	void commit() {
-		time_t started = time(nullptr);
+		auto started = chrono::steady_clock::now();
 
 		client.commit_transaction();
 
 		if (verbose && commit_level == CommitLevel::success) {
-			time_t now = time(nullptr);
+			auto now = chrono::steady_clock::now();
 			unique_lock<mutex> lock(sync_queue.mutex);
-			cout << "committed in " << (now - started) << "s" << endl << flush;
+			cout << "committed in " << chrono::duration_cast<chrono::milliseconds>(now - started).count() << "ms" << endl << flush;
 		}
 	}
 
 	void rollback() {
-		time_t started = time(nullptr);
+		auto started = chrono::steady_clock::now();
 
 		client.rollback_transaction();
 
 		if (verbose) {
-			time_t now = time(nullptr);
+			auto now = chrono::steady_clock::now();
 			unique_lock<mutex> lock(sync_queue.mutex);
-			cout << "rolled back in " << (now - started) << "s" << endl << flush;
+			cout << "rolled back in " << chrono::duration_cast<chrono::milliseconds>(now - started).count() << "ms" << endl << flush;
 		}
 	}
 
@@ -370,18 +386,19 @@ template <typename DatabaseClient, typename... Options>
 void sync_to(int num_workers, int startfd, const Options &...options) {
 	Database database;
 	SyncQueue<DatabaseClient> sync_queue(num_workers);
-	vector<SyncToWorker<DatabaseClient>*> workers;
-
-	workers.resize(num_workers);
+	list<SyncToWorker<DatabaseClient>> workers; // list so that the worker objects don't move when others are added
 
 	for (int worker = 0; worker < num_workers; worker++) {
 		bool leader = (worker == 0);
 		int read_from_descriptor = startfd + worker;
 		int write_to_descriptor = startfd + worker + num_workers;
-		workers[worker] = new SyncToWorker<DatabaseClient>(database, sync_queue, leader, worker, read_from_descriptor, write_to_descriptor, options...);
+		workers.emplace_back(database, sync_queue, leader, worker, read_from_descriptor, write_to_descriptor, options...);
 	}
 
-	for (SyncToWorker<DatabaseClient>* worker : workers) delete worker;
+	// start the threads only once all the workers have been constructed, so they can't be touching
+	// the shared structures if construction of one of the others fails
+	for (SyncToWorker<DatabaseClient> &worker : workers) worker.start();
+	for (SyncToWorker<DatabaseClient> &worker : workers) worker.join();
 
 	if (sync_queue.aborted) throw sync_error();
 }
@@ -29,6 +29,14 @@ struct SyncToAlgorithm {
 		target_maximum_block_size(worker.target_maximum_block_size) {
 	}
 
+	// builds the whole debug trace line up front and writes it to the stream in one go, which is both
+	// cheaper than pushing each fragment through cout and stops lines from different workers interleaving
+	inline void trace(const string &description) {
+		ostringstream line;
+		line << timestamp() << " worker " << worker.worker_number << ' ' << description << '\n';
+		cout << line.str() << flush;
+	}
+
 	void sync_tables() {
 		while (true) {
 			// grab the next table to work on from the queue, blocking if there's nothing to do right now, quitting if the whole sync is finished
@@ -39,7 +47,7 @@ struct SyncToAlgorithm {
 	}
 
 	void start_sync_table(const shared_ptr<TableJob> &table_job, RowReplacer<DatabaseClient> &row_replacer) {
-		table_job->time_started = time(nullptr);
+		table_job->time_started = chrono::steady_clock::now();
 
 		if (worker.verbose) {
 			unique_lock<mutex> lock(sync_queue.mutex);
@@ -50,7 +58,7 @@ struct SyncToAlgorithm {
 
 		if (table_job->table.primary_key_type != PrimaryKeyType::no_available_key) {
 			// start by scoping out the table
-			if (worker.verbose > 1) cout << timestamp() << " worker " << worker.worker_number << " <- range " << table_job->table.name << endl;
+			if (worker.verbose > 1) trace("<- range " + table_job->table.name);
 			send_command(output, Commands::RANGE, table_job->table_id);
 			if (input.next<verb_t>() != Commands::RANGE) throw command_error("Didn't receive response to RANGE command");
 			handle_range_response(table_job, row_replacer);
@@ -67,10 +75,10 @@ struct SyncToAlgorithm {
 		ResetTableSequences<DatabaseClient>::execute(client, table_job->table);
 
 		if (worker.verbose) {
-			table_job->time_finished = time(nullptr);
+			table_job->time_finished = chrono::steady_clock::now();
 			unique_lock<mutex> lock(sync_queue.mutex);
 			if (worker.verbose > 1) cout << timestamp() << " worker " << worker.worker_number << ' ';
-			cout << "finished " << table_job->table.name << " in " << (table_job->time_finished - table_job->time_started) << "s using " << table_job->hash_commands << " hash commands and " << table_job->rows_commands << " rows commands changing " << rows_changed << " rows" << endl << flush;
+			cout << "finished " << table_job->table.name << " in " << chrono::duration_cast<chrono::milliseconds>(table_job->time_finished - table_job->time_started).count() << "ms using " << table_job->hash_commands << " hash commands and " << table_job->rows_commands << " rows commands changing " << rows_changed << " rows" << endl << flush;
 		}
 	}
 
@@ -80,7 +88,7 @@ struct SyncToAlgorithm {
 			[&] { if (worker.progress) { cout << "." << flush; } });
 
 		// if the table hasn't been started, become the writer worker for it; otherwise just help out with range checks
-		bool writer = !table_job->time_started;
+		bool writer = (table_job->time_started == chrono::steady_clock::time_point());
 		if (writer) start_sync_table(table_job, row_replacer);
 
 		size_t outstanding_commands = 0;
@@ -103,7 +111,9 @@ struct SyncToAlgorithm {
 				send_rows_command(table_job, range_to_retrieve);
 
 			} else if (outstanding_commands < max_outstanding_commands && !table_job->ranges_to_check.empty()) {
-				KeyRangeToCheck range_to_check(std::move(table_job->ranges_to_check.top()));
+				// top() returns a const reference, so moving from it directly would silently copy the
+				// packed keys; we're about to pop() the entry anyway, so it's safe to cast that away
+				KeyRangeToCheck range_to_check(std::move(const_cast<KeyRangeToCheck &>(table_job->ranges_to_check.top())));
 				table_job->ranges_to_check.pop();
 				table_job->hash_commands++;
 				lock.unlock(); // don't hold the mutex while doing IO
@@ -152,8 +162,11 @@ struct SyncToAlgorithm {
 	inline void send_rows_command(const shared_ptr<TableJob> &table_job, const KeyRange &range_to_retrieve) {
 		const ColumnValues &prev_key(get<0>(range_to_retrieve));
 		const ColumnValues &last_key(get<1>(range_to_retrieve));
-		if (worker.verbose > 1) cout << timestamp() << " worker " << worker.worker_number << " <- rows " << table_job->table.name << ' ' << values_list(client, table_job->table, prev_key) << ' ' << values_list(client, table_job->table, last_key) << endl;
-		send_command(output, Commands::ROWS, table_job->table_id, prev_key, last_key);
+		if (worker.verbose > 1) trace("<- rows " + table_job->table.name + ' ' + values_list(client, table_job->table, prev_key) + ' ' + values_list(client, table_job->table, last_key));
+		// rows commands need no work at our end before we see the response, so unlike hash commands there's
+		// nothing to overlap; leave them in the write buffer so they can coalesce with whatever we send next,
+		// and flush before we block waiting for responses (in handle_response/request_rows_without_pipelining)
+		send_command_without_flush(output, Commands::ROWS, table_job->table_id, prev_key, last_key);
 	}
 
 	inline void send_hash_command(const shared_ptr<TableJob> &table_job, const KeyRangeToCheck &range_to_check, list<HashResult> &ranges_hashed) {
@@ -163,7 +176,7 @@ struct SyncToAlgorithm {
 		if (range_to_check.rows_to_hash == 0) throw logic_error("Can't hash 0 rows");
 
 		// tell the other end to hash this range
-		if (worker.verbose > 1) cout << timestamp() << " worker " << worker.worker_number << " <- hash " << table.name << ' ' << values_list(client, table, prev_key) << ' ' << values_list(client, table, last_key) << ' ' << range_to_check.rows_to_hash << endl;
+		if (worker.verbose > 1) trace("<- hash " + table.name + ' ' + values_list(client, table, prev_key) + ' ' + values_list(client, table, last_key) + ' ' + to_string(range_to_check.rows_to_hash));
 		send_command(output, Commands::HASH, table_job->table_id, prev_key, last_key, range_to_check.rows_to_hash);
 
 		// while that end is working, do the same at our end
@@ -202,6 +215,8 @@ struct SyncToAlgorithm {
 	}
 
 	inline void handle_response(const shared_ptr<TableJob> &table_job, list<HashResult> &ranges_hashed, RowReplacer<DatabaseClient> &row_replacer) {
+		output.flush(); // push out any coalesced commands before we block waiting for the response
+
 		verb_t verb;
 		input >> verb;
 
@@ -223,7 +238,7 @@ struct SyncToAlgorithm {
 		string _table_name;
 		ColumnValues their_first_key, their_last_key;
 		read_all_arguments(input, _table_name, their_first_key, their_last_key);
-		if (worker.verbose > 1) cout << timestamp() << " worker " << worker.worker_number << " -> range " << table_job->table.name << ' ' << values_list(client, table_job->table, their_first_key) << ' ' << values_list(client, table_job->table, their_last_key) << endl;
+		if (worker.verbose > 1) trace("-> range " + table_job->table.name + ' ' + values_list(client, table_job->table, their_first_key) + ' ' + values_list(client, table_job->table, their_last_key));
 
 		if (their_first_key.empty()) {
 			client.execute("DELETE FROM " + client.quote_table_name(table_job->table));
@@ -279,6 +294,7 @@ struct SyncToAlgorithm {
 
 	void request_rows_without_pipelining(const shared_ptr<TableJob> &table_job, RowReplacer<DatabaseClient> &row_replacer, const KeyRange &range_to_retrieve) {
 		send_rows_command(table_job, range_to_retrieve);
+		output.flush();
 		if (input.next<verb_t>() != Commands::ROWS) throw command_error("Didn't receive response to ROWS command");
 		handle_rows_response(table_job->table, row_replacer, true);
 
@@ -293,7 +309,7 @@ struct SyncToAlgorithm {
 		string table_name;
 		ColumnValues prev_key, last_key;
 		read_array(input, table_name, prev_key, last_key); // the first array gives the range arguments, which is followed by one array for each row
-		if (worker.verbose > 1) cout << timestamp() << " worker " << worker.worker_number << " -> rows " << table.name << ' ' << values_list(client, table, prev_key) << ' ' << values_list(client, table, last_key) << endl;
+		if (worker.verbose > 1) trace("-> rows " + table.name + ' ' + values_list(client, table, prev_key) + ' ' + values_list(client, table, last_key));
 
 		if (final_rows) {
 			RowInserter<DatabaseClient>(row_replacer, table).stream_from_input(input);
@@ -316,7 +332,7 @@ struct SyncToAlgorithm {
 		if (table_name != table.name || prev_key != hash_result.prev_key || last_key != hash_result.last_key) throw command_error("Didn't issue hash command for " + table.name + " " + values_list(client, table, prev_key) + " " + values_list(client, table, last_key));
 
 		bool match = (hash_result.our_hash == their_hash && hash_result.our_row_count == their_row_count);
-		if (worker.verbose > 1) cout << timestamp() << " worker " << worker.worker_number << " -> hash " << table.name << ' ' << values_list(client, table, prev_key) << ' ' << values_list(client, table, last_key) << ' ' << their_row_count << (match ? " matches" : " doesn't match") << endl;
+		if (worker.verbose > 1) trace("-> hash " + table.name + ' ' + values_list(client, table, prev_key) + ' ' + values_list(client, table, last_key) + ' ' + to_string(their_row_count) + (match ? " matches" : " doesn't match"));
 
 		std::unique_lock<std::mutex> lock(table_job->mutex);
 
@@ -369,12 +385,13 @@ struct SyncToAlgorithm {
 
 		table_job->hash_commands_completed++;
 
-		if (worker.verbose > 1) cout << timestamp() << " worker " << worker.worker_number << "         " << table.name << " has " << table_job->ranges_to_check.size() << " range(s) to check and " << table_job->ranges_to_retrieve.size() << " to retrieve, " << string(table_job->notify_when_work_could_be_shared ? "sharing wanted" : "sharing not needed") << endl;
+		if (worker.verbose > 1) trace("        " + table.name + " has " + to_string(table_job->ranges_to_check.size()) + " range(s) to check and " + to_string(table_job->ranges_to_retrieve.size()) + " to retrieve, " + (table_job->notify_when_work_could_be_shared ? "sharing wanted" : "sharing not needed"));
 
 		if (table_job->notify_when_work_could_be_shared) {
 			table_job->borrowed_task_completed.notify_all(); // not really borrowed if we are the writer worker, but since only the writer waits on this condition it's moot
+			bool worth_sharing = table_job->have_work_to_share(); // check before unlocking, the queues are protected by the table job's mutex
 			lock.unlock();
-			sync_queue.have_work_to_share(table_job);
+			if (worth_sharing) sync_queue.have_work_to_share(table_job);
 		}
 	}
 
@@ -4,6 +4,10 @@
 #include <string>
 #include <sstream>
 
+// fallback for the types std::to_string doesn't cover, such as our enums.  note that because
+// overload resolution prefers non-templates, unqualified to_string calls on plain integers still
+// pick std::to_string, which formats without streams or locale lookups - this template is only
+// instantiated for everything else.
 template <typename T>
 std::string to_string(T n) {
 	std::ostringstream stream;
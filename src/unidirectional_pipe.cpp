@@ -5,13 +5,26 @@
 #include <cerrno>
 #include <cstring>
 #include <unistd.h>
+#include <fcntl.h>
 
 using namespace std;
 
 UnidirectionalPipe::UnidirectionalPipe() {
+	// we create the descriptors close-on-exec so they don't leak into every other child spawned
+	// while this pipe exists - for example, each worker's ssh process used to inherit and hold open
+	// every other worker's pipe ends, which could delay the other ends seeing the pipes close.
+	// the ends a child actually should have are attached by dup2, which clears the flag on the copy.
+#ifdef __linux__
+	if (pipe2(pipe_handles, O_CLOEXEC) < 0) {
+		throw runtime_error("Couldn't create a pipe: " + string(strerror(errno)));
+	}
+#else
 	if (pipe(pipe_handles) < 0) {
 		throw runtime_error("Couldn't create a pipe: " + string(strerror(errno)));
 	}
+	fcntl(pipe_handles[0], F_SETFD, FD_CLOEXEC);
+	fcntl(pipe_handles[1], F_SETFD, FD_CLOEXEC);
+#endif
 }
 
 UnidirectionalPipe::~UnidirectionalPipe() {